@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+    Channel-interleaved FIR filter. All channels are packed into SIMD
+    registers and filtered in lockstep, so every coefficient is broadcast
+    once per sample and shared by all channels.
+
+  ==============================================================================
+*/
+
+#include "InterleavedFIR.h"
+
+//==============================================================================
+void InterleavedFIR::prepare (const juce::dsp::ProcessSpec& spec)
+{
+    numGroups = getNumGroups(static_cast<int>(spec.numChannels));
+    jassert(numGroups <= maxGroups);
+
+    reset();
+}
+
+void InterleavedFIR::reset()
+{
+    size = static_cast<int>(state->getFilterSize());
+    pos = 0;
+
+    // Two copies of the history, one register per channel group. Only grow the
+    // storage, so resetting for the same or a shorter filter never allocates.
+    const auto required = static_cast<size_t>(2 * size * numGroups);
+
+    if (required > fifo.size())
+        fifo.assign(required, SIMDDouble());
+    else
+        std::fill(fifo.begin(), fifo.end(), SIMDDouble());
+}
+
+void InterleavedFIR::process (SIMDDouble* frames, int numChannels, int numSamples) noexcept
+{
+    // The frames must use the stride this filter was prepared for
+    jassert(getNumGroups(numChannels) == numGroups);
+
+    // Coefficients were replaced with a different length, start over with a clean history
+    if (static_cast<int>(state->getFilterSize()) != size)
+        reset();
+
+    if (size == 0)
+        return;
+
+    switch (numGroups)
+    {
+        case 1: processGroups<1>(frames, numSamples); break;
+        case 2: processGroups<2>(frames, numSamples); break;
+        case 3: processGroups<3>(frames, numSamples); break;
+        case 4: processGroups<4>(frames, numSamples); break;
+        default: jassertfalse; break;
+    }
+}
+
+template <int Groups>
+void InterleavedFIR::processGroups (SIMDDouble* frames, int numSamples) noexcept
+{
+    const auto* coefs = state->getRawCoefficients();
+    auto* history = fifo.data();
+    const int taps = size;
+    int p = pos;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto* frame = frames + i * Groups;
+        const auto* head = history + p * Groups;
+
+        for (int g = 0; g < Groups; ++g)
+            history[p * Groups + g] = history[(p + taps) * Groups + g] = frame[g];
+
+        // head[j * Groups + g] holds the sample from j steps ago
+        if constexpr (Groups == 1)
+        {
+            // A single register, so split the sum four ways to hide the add latency
+            SIMDDouble a0 {}, a1 {}, a2 {}, a3 {};
+            int j = 0;
+
+            for (; j + 4 <= taps; j += 4)
+            {
+                a0 = SIMDDouble::multiplyAdd(a0, head[j + 0], SIMDDouble::expand(coefs[j + 0]));
+                a1 = SIMDDouble::multiplyAdd(a1, head[j + 1], SIMDDouble::expand(coefs[j + 1]));
+                a2 = SIMDDouble::multiplyAdd(a2, head[j + 2], SIMDDouble::expand(coefs[j + 2]));
+                a3 = SIMDDouble::multiplyAdd(a3, head[j + 3], SIMDDouble::expand(coefs[j + 3]));
+            }
+
+            for (; j < taps; ++j)
+                a0 = SIMDDouble::multiplyAdd(a0, head[j], SIMDDouble::expand(coefs[j]));
+
+            a0 += a1;
+            a2 += a3;
+            a0 += a2;
+            frame[0] = a0;
+        }
+        else
+        {
+            // One accumulator per group, each coefficient is expanded once and applied to all of them
+            SIMDDouble a0 {}, a1 {}, a2 {}, a3 {};
+
+            for (int j = 0; j < taps; ++j)
+            {
+                const auto coef = SIMDDouble::expand(coefs[j]);
+                const auto* x = head + j * Groups;
+
+                a0 = SIMDDouble::multiplyAdd(a0, x[0], coef);
+                a1 = SIMDDouble::multiplyAdd(a1, x[1], coef);
+                if constexpr (Groups > 2) a2 = SIMDDouble::multiplyAdd(a2, x[2], coef);
+                if constexpr (Groups > 3) a3 = SIMDDouble::multiplyAdd(a3, x[3], coef);
+            }
+
+            frame[0] = a0;
+            frame[1] = a1;
+            if constexpr (Groups > 2) frame[2] = a2;
+            if constexpr (Groups > 3) frame[3] = a3;
+        }
+
+        if (--p < 0)
+            p += taps;
+    }
+
+    pos = p;
+}
+
+//==============================================================================
+int InterleavedFIR::getNumGroups (int numChannels) noexcept
+{
+    return (numChannels + lanes - 1) / lanes;
+}
+
+void InterleavedFIR::interleave (const juce::AudioBuffer<float>& source, int startSample, SIMDDouble* frames, int numSamples) noexcept
+{
+    const int numChannels = source.getNumChannels();
+    const int groups = getNumGroups(numChannels);
+    auto* const* channels = source.getArrayOfReadPointers();
+
+    alignas(SIMDDouble::SIMDRegisterSize) double scratch[lanes];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int g = 0; g < groups; ++g)
+        {
+            for (int l = 0; l < lanes; ++l)
+            {
+                const int ch = g * lanes + l;
+                scratch[l] = ch < numChannels ? static_cast<double>(channels[ch][startSample + i]) : 0.0;
+            }
+
+            frames[i * groups + g] = SIMDDouble::fromRawArray(scratch);
+        }
+    }
+}
+
+void InterleavedFIR::deinterleave (const SIMDDouble* frames, juce::AudioBuffer<float>& dest, int startSample, int numSamples) noexcept
+{
+    const int numChannels = dest.getNumChannels();
+    const int groups = getNumGroups(numChannels);
+    auto* const* channels = dest.getArrayOfWritePointers();
+
+    alignas(SIMDDouble::SIMDRegisterSize) double scratch[lanes];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int g = 0; g < groups; ++g)
+        {
+            frames[i * groups + g].copyToRawArray(scratch);
+
+            for (int l = 0; l < lanes && g * lanes + l < numChannels; ++l)
+                channels[g * lanes + l][startSample + i] = static_cast<float>(scratch[l]);
+        }
+    }
+}
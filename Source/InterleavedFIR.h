@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    Channel-interleaved FIR filter. All channels are packed into SIMD
+    registers and filtered in lockstep, so every coefficient is broadcast
+    once per sample and shared by all channels.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Multichannel FIR filter working on channel-interleaved audio.
+
+    Samples are laid out frame by frame: for every sample index there are
+    getNumGroups (numChannels) SIMD registers, each holding one sample of
+    SIMDDouble::SIMDNumElements consecutive channels. Unused lanes of the last
+    register are zero padded.
+*/
+class InterleavedFIR
+{
+public:
+    using SIMDDouble = juce::dsp::SIMDRegister<double>;
+
+    static constexpr int maxChannels = 8;
+    static constexpr int lanes = static_cast<int>(SIMDDouble::SIMDNumElements);
+    static constexpr int maxGroups = (maxChannels + lanes - 1) / lanes;
+
+    //==============================================================================
+    /** Allocates and clears the history for the current coefficients, so set them before calling this. */
+    void prepare (const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    /** Filters numSamples interleaved frames of numChannels channels in place. */
+    void process (SIMDDouble* frames, int numChannels, int numSamples) noexcept;
+
+    //==============================================================================
+    /** Number of SIMD registers needed to hold one sample of every channel. */
+    static int getNumGroups (int numChannels) noexcept;
+
+    /** Transposes numSamples of planar float audio, from startSample on, into interleaved double frames. */
+    static void interleave (const juce::AudioBuffer<float>& source, int startSample, SIMDDouble* frames, int numSamples) noexcept;
+
+    /** Transposes interleaved double frames back into planar float audio, from startSample on. */
+    static void deinterleave (const SIMDDouble* frames, juce::AudioBuffer<float>& dest, int startSample, int numSamples) noexcept;
+
+    //==============================================================================
+    juce::dsp::FIR::Coefficients<double>::Ptr state = new juce::dsp::FIR::Coefficients<double>();
+
+private:
+    template <int Groups>
+    void processGroups (SIMDDouble* frames, int numSamples) noexcept;
+
+    // History is stored twice back to back so every tap can be read contiguously
+    std::vector<SIMDDouble> fifo;
+
+    int numGroups = 0;
+    int size = 0;
+    int pos = 0;
+};
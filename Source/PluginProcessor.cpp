@@ -99,16 +99,15 @@ void FIRFilterAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBl
     spec.maximumBlockSize = samplesPerBlock;
     spec.numChannels = getMainBusNumOutputChannels();
 
+    // Coefficients first, so the filters size their history for them here and not on the audio thread
+    updateCoefficients(sampleRate);
+
     highPass.prepare(spec);
-    highPass.reset();
     lowPass.prepare(spec);
-    lowPass.reset();
 
-    // Resize the workbench buffer (no audio processing here, just memory allocation)
-    doubleBuffer.setSize(getMainBusNumOutputChannels(), samplesPerBlock);
-    doubleBuffer.clear(); // Ensure it starts at zero!
-
-    updateCoefficients(sampleRate);
+    // Resize the interleaved workbench buffer (no audio processing here, just memory allocation)
+    interleavedBuffer.assign(static_cast<size_t>(samplesPerBlock * InterleavedFIR::getNumGroups(getMainBusNumOutputChannels())),
+        InterleavedFIR::SIMDDouble()); // Ensure it starts at zero!
 }
 
 void FIRFilterAudioProcessor::releaseResources()
@@ -124,12 +123,10 @@ bool FIRFilterAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Accept any layout from mono up to 8 channels (e.g. stereo, quad, 5.1, 7.1);
+    // the interleaved FIR filters all of them together.
+    if (layouts.getMainOutputChannelSet().isDisabled()
+     || layouts.getMainOutputChannelSet().size() > InterleavedFIR::maxChannels)
         return false;
 
     // This checks if the input layout matches the output layout
@@ -149,29 +146,14 @@ void FIRFilterAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, ju
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i) {
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
-        doubleBuffer.clear(i, 0, doubleBuffer.getNumSamples());
-    }
 
     int numSamples = buffer.getNumSamples();
     int numChannels = buffer.getNumChannels();
 
     updateCoefficients(getSampleRate());
 
-    // -----------------------------------------------------------
-    // 1. UPSample to 64-bit (Float -> Double)
-    // -----------------------------------------------------------
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto* floatRead = buffer.getReadPointer(ch);
-        auto* doubleWrite = doubleBuffer.getWritePointer(ch);
-
-        for (int i = 0; i < numSamples; ++i) {
-            doubleWrite[i] = static_cast<double>(floatRead[i]);
-        }
-    }
-
     // 1. Check if the buffer is silent
     if (buffer.getMagnitude(0, numSamples) < 0.000001f) // Roughly -120dB
     {
@@ -187,27 +169,29 @@ void FIRFilterAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, ju
         silentBlockCount = 0;
     }
 
-    juce::dsp::AudioBlock<double> doubleBlock(doubleBuffer.getArrayOfWritePointers(),
-        doubleBuffer.getNumChannels(),
-        numSamples);
-
     auto hpIsBypassed = parameters.getRawParameterValue("bypassHp")->load();
     auto lpIsBypassed = parameters.getRawParameterValue("bypassLp")->load();
 
-    if (!hpIsBypassed) highPass.process(juce::dsp::ProcessContextReplacing<double>(doubleBlock));
-    
-    if (!lpIsBypassed) lowPass.process(juce::dsp::ProcessContextReplacing<double>(doubleBlock));
+    // The workbench buffer holds samplesPerBlock frames, hosts may send bigger blocks so work through it in chunks
+    const int chunkSize = static_cast<int>(interleavedBuffer.size()) / juce::jmax(1, InterleavedFIR::getNumGroups(numChannels));
+    jassert(chunkSize > 0);
 
-    // 3. Cast back to 32-bit (Double -> Float) for the DAW
-    // -----------------------------------------------------------
-    for (int ch = 0; ch < numChannels; ++ch)
+    for (int start = 0; chunkSize > 0 && start < numSamples; start += chunkSize)
     {
-        auto* doubleRead = doubleBuffer.getReadPointer(ch);
-        auto* floatWrite = buffer.getWritePointer(ch);
+        const int chunkSamples = juce::jmin(chunkSize, numSamples - start);
 
-        for (int i = 0; i < numSamples; ++i) {
-            floatWrite[i] = static_cast<float>(doubleRead[i]);
-        }
+        // -----------------------------------------------------------
+        // 2. Transpose to interleaved 64-bit (planar Float -> interleaved Double)
+        // -----------------------------------------------------------
+        InterleavedFIR::interleave(buffer, start, interleavedBuffer.data(), chunkSamples);
+
+        if (!hpIsBypassed) highPass.process(interleavedBuffer.data(), numChannels, chunkSamples);
+
+        if (!lpIsBypassed) lowPass.process(interleavedBuffer.data(), numChannels, chunkSamples);
+
+        // 3. Transpose back to 32-bit (interleaved Double -> planar Float) for the DAW
+        // -----------------------------------------------------------
+        InterleavedFIR::deinterleave(interleavedBuffer.data(), buffer, start, chunkSamples);
     }
 }
 
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "InterleavedFIR.h"
 
 //==============================================================================
 /**
@@ -59,12 +60,11 @@ public:
 
     //==============================================================================
     juce::AudioProcessorValueTreeState parameters;
-    juce::AudioBuffer<double> doubleBuffer;
+    std::vector<InterleavedFIR::SIMDDouble> interleavedBuffer;
 
 private:
-    // Filters
-    using StereoFIR = juce::dsp::ProcessorDuplicator<juce::dsp::FIR::Filter<double>, juce::dsp::FIR::Coefficients<double>>;
-    StereoFIR highPass, lowPass;
+    // Filters (all channels processed together, sharing one coefficient pass)
+    InterleavedFIR highPass, lowPass;
 
     // Stored values for knowing when to update coefficients
     float lastHpCutoff = -1.0f;  // Store last used HPF cutoff